@@ -8,7 +8,10 @@
 #define WT_DBO_DBACTION_IMPL_H_
 
 #include <Wt/Dbo/Exception>
+#include <Wt/Dbo/ObjectCache>
+#include <algorithm>
 #include <iostream>
+#include <map>
 #include <boost/lexical_cast.hpp>
 
 namespace Wt {
@@ -284,29 +287,63 @@ void LoadDbAction<C>::visit(C& obj)
   bool continueStatement = statement_ != 0;
   Session *session = dbo_.session();
 
-  if (!continueStatement) {
-    use(statement_ = session->template getStatement<C>(Session::SqlSelectById));
-    statement_->reset();
+  /*
+   * When loading by id, the object may be found in the shared cache,
+   * otherwise the row that is read is stored in the cache.
+   */
+  ObjectCache *cache = continueStatement ? 0 : mapping().objectCache;
+  std::string cacheId;
+  SqlStatement *cached = 0;
+  bool cacheHit = false;
+  long long cacheGeneration = 0;
+
+  if (cache) {
+    cacheGeneration = session->cacheGeneration();
+    cacheId = boost::lexical_cast<std::string>(dbo_.id());
+    cached = cache->find(mapping().tableName, cacheId);
+    cacheHit = cached != 0;
+  }
 
-    int column = 0;
-    MetaDboBase *dbo = dynamic_cast<MetaDboBase *>(&dbo_);
-    dbo->bindId(statement_, column);
+  try {
+    if (cacheHit)
+      statement_ = cached;
+    else if (!continueStatement) {
+      use(statement_
+	  = session->template getStatement<C>(Session::SqlSelectById));
+      statement_->reset();
 
-    statement_->execute();
+      int column = 0;
+      MetaDboBase *dbo = dynamic_cast<MetaDboBase *>(&dbo_);
+      dbo->bindId(statement_, column);
+
+      statement_->execute();
+
+      if (!statement_->nextRow()) {
+	throw ObjectNotFoundException(session->template tableName<C>(),
+				      boost::lexical_cast<std::string>(dbo_.id()));
+      }
 
-    if (!statement_->nextRow()) {
-      throw ObjectNotFoundException(session->template tableName<C>(), 
-				    boost::lexical_cast<std::string>(dbo_.id()));
+      if (cache)
+	statement_ = cached = cache->record(statement_);
     }
-  }
 
-  start();
+    start();
 
-  persist<C>::apply(obj, *this);
+    persist<C>::apply(obj, *this);
+
+    if (!continueStatement && statement_->nextRow())
+      throw Exception("Dbo load: multiple rows for id "
+		      + boost::lexical_cast<std::string>(dbo_.id()) + " ??");
 
-  if (!continueStatement && statement_->nextRow())
-    throw Exception("Dbo load: multiple rows for id "
-		    + boost::lexical_cast<std::string>(dbo_.id()) + " ??");
+    if (cached && !cacheHit)
+      cache->store(mapping().tableName, cacheId, cached,
+		   mapping().versionFieldName != 0, cacheGeneration);
+  } catch (...) {
+    delete cached;
+    throw;
+  }
+
+  delete cached;
 
   if (continueStatement)
     use(0);
@@ -342,8 +379,12 @@ void SaveBaseAction::actPtr(const PtrRef<C>& field)
   case Dependencies:
     {
       MetaDboBase *dbob = field.value().obj();
-      if (dbob)
+      if (dbob) {
 	dbob->flush();
+
+	// we need its id
+	session()->executeBatchedInserts(dbob);
+      }
     }
 
     break;
@@ -411,6 +452,7 @@ void SaveBaseAction::actCollection(const CollectionRef<C>& field)
 
 	    // Make sure it is saved
 	    dbo2->flush();
+	    session()->executeBatchedInserts(dbo2);
 
 	    statement->reset();
 	    int column = 0;
@@ -489,9 +531,15 @@ void SaveDbAction<C>::visit(C& obj)
       isInsert_ = dbo_.deletedInTransaction()
 	|| (dbo_.isNew() && !dbo_.savedInTransaction());
 
-      use(statement_ = isInsert_
-	  ? dbo_.session()->template getStatement<C>(Session::SqlInsert)
-	  : dbo_.session()->template getStatement<C>(Session::SqlUpdate));
+      if (isInsert_)
+	statement_ = dbo_.session()->batchedInsertStatement(&mapping());
+
+      batched_ = statement_ != 0;
+
+      if (!batched_)
+	use(statement_ = isInsert_
+	    ? dbo_.session()->template getStatement<C>(Session::SqlInsert)
+	    : dbo_.session()->template getStatement<C>(Session::SqlUpdate));
     } else
       isInsert_ = false;
 
@@ -877,6 +925,258 @@ template<class C>
 void FromAnyAction::actCollection(const CollectionRef<C>& field)
 { }
 
+    /*
+     * PrefetchAction
+     */
+
+template<class C>
+void PrefetchAction::visit(const ptr<C>& obj)
+{
+  typedef typename boost::remove_const<C>::type MutC;
+  typedef typename dbo_traits<MutC>::IdType IdType;
+
+  hasKey_ = Impl::PrefetchKey<IdType>::key(obj.id(), key_);
+  readKey_ = &Impl::PrefetchKey<IdType>::read;
+
+  persist<MutC>::apply(const_cast<MutC&>(*obj), *this);
+}
+
+template<typename V>
+void PrefetchAction::actId(V& value, const std::string& name, int size)
+{ }
+
+template<class C>
+void PrefetchAction::actId(ptr<C>& value, const std::string& name, int size,
+			   int fkConstraints)
+{
+  actPtr(PtrRef<C>(value, name, fkConstraints));
+}
+
+template<typename V>
+void PrefetchAction::act(const FieldRef<V>& field)
+{ }
+
+template<class C>
+void PrefetchAction::actPtr(const PtrRef<C>& field)
+{
+  if (field.name() != relation_ || !field.value())
+    return;
+
+  if (!prefetch_)
+    prefetch_ = new Impl::PtrPrefetch<C>();
+
+  Impl::PtrPrefetch<C> *p = dynamic_cast<Impl::PtrPrefetch<C> *>(prefetch_);
+  if (p)
+    p->targets.push_back(field.value());
+}
+
+template<class C>
+void PrefetchAction::actWeakPtr(const WeakPtrRef<C>& field)
+{ }
+
+template<class C>
+void PrefetchAction::actCollection(const CollectionRef<C>& field)
+{
+  if (field.joinName() != relation_ || !hasKey_)
+    return;
+
+  if (!prefetch_)
+    prefetch_ = new Impl::CollectionPrefetch<C>(readKey_);
+
+  Impl::CollectionPrefetch<C> *p
+    = dynamic_cast<Impl::CollectionPrefetch<C> *>(prefetch_);
+  if (p) {
+    typename Impl::CollectionPrefetch<C>::Owner owner;
+    owner.key = key_;
+    owner.value = &field.value();
+    p->owners.push_back(owner);
+  }
+}
+
+    namespace Impl {
+
+template <class C>
+void PtrPrefetch<C>::run(Session& session)
+{
+  typedef typename boost::remove_const<C>::type MutC;
+  typedef typename Session::Mapping<MutC>::Registry Registry;
+
+  Session::Mapping<MutC> *mapping = session.getMapping<MutC>();
+
+  /*
+   * An object with a natural id is only matched with the object in
+   * the session after it has been read.
+   */
+  if (!mapping->surrogateIdFieldName)
+    return;
+
+  /*
+   * Only objects that have not yet been loaded, each only once.
+   */
+  std::vector<MetaDboBase *> pending;
+  std::set<MetaDboBase *> seen;
+
+  for (unsigned i = 0; i < targets.size(); ++i) {
+    typename Registry::iterator j = mapping->registry_.find(targets[i].id());
+
+    if (j != mapping->registry_.end() && !j->second->isLoaded()
+	&& seen.insert(j->second).second)
+      pending.push_back(j->second);
+  }
+
+  for (unsigned i = 0; i < pending.size();) {
+    int remaining = static_cast<int>(pending.size() - i);
+    int size = prefetchBatchSize(remaining);
+    int count = (std::min)(size, remaining);
+
+    std::string sql = "select " + prefetchColumns(mapping)
+      + " from \"" + quoteSchemaDot(mapping->tableName) + "\" where "
+      + prefetchCondition(mapping->idCondition, size);
+
+    SqlStatement *statement = session.getOrPrepareStatement(sql);
+    ScopedStatementUse use(statement);
+
+    /*
+     * Unused parameters are bound to the last id.
+     */
+    statement->reset();
+    int column = 0;
+    for (int j = 0; j < size; ++j)
+      pending[i + (std::min)(j, count - 1)]->bindId(statement, column);
+
+    statement->execute();
+
+    while (statement->nextRow()) {
+      int column = 0;
+      session.load<MutC>(statement, column);
+    }
+
+    i += count;
+  }
+}
+
+template <class C>
+void CollectionPrefetch<C>::run(Session& session)
+{
+  typedef typename collection< ptr<C> >::RelationData RelationData;
+
+  std::vector<Owner *> pending;
+  const std::string *sql = 0;
+
+  for (unsigned i = 0; i < owners.size(); ++i) {
+    collection< ptr<C> > *c = owners[i].value;
+
+    if (c->type_ == collection< ptr<C> >::RelationCollection) {
+      const RelationData& relation = c->data_.relation;
+
+      if (relation.sql && relation.dbo) {
+	if (!sql)
+	  sql = relation.sql;
+
+	if (*relation.sql == *sql)
+	  pending.push_back(&owners[i]);
+      }
+    }
+  }
+
+  if (!sql)
+    return;
+
+  /*
+   * The relation is queried using: select ... where "key" = ?
+   *
+   * We select the key too, to match the results with the owners.
+   */
+  const std::string select = "select ", where = " where ";
+
+  std::size_t w = sql->rfind(where);
+  if (sql->compare(0, select.length(), select) != 0
+      || w == std::string::npos)
+    return;
+
+  std::string condition = sql->substr(w + where.length());
+  std::size_t eq = condition.find(" = ?");
+  if (eq == std::string::npos
+      || eq + 4 != condition.length()
+      || condition.find('?') != eq + 3)
+    return;
+
+  std::string key = condition.substr(0, eq);
+  std::string from = sql->substr(select.length(), w - select.length());
+
+  std::map<std::string, std::vector< ptr<C> > > results;
+
+  for (unsigned i = 0; i < pending.size();) {
+    int remaining = static_cast<int>(pending.size() - i);
+    int size = prefetchBatchSize(remaining);
+    int count = (std::min)(size, remaining);
+
+    SqlStatement *statement = session.getOrPrepareStatement
+      (select + key + ", " + from + where + prefetchCondition(condition, size));
+    ScopedStatementUse use(statement);
+
+    statement->reset();
+    int column = 0;
+    for (int j = 0; j < size; ++j)
+      pending[i + (std::min)(j, count - 1)]->value->data_.relation.dbo
+	->bindId(statement, column);
+
+    statement->execute();
+
+    while (statement->nextRow()) {
+      std::string k;
+      if (!readKey(statement, 0, k))
+	continue;
+
+      int column = 1;
+      results[k].push_back
+	(query_result_traits< ptr<C> >::load(session, *statement, column));
+    }
+
+    i += count;
+  }
+
+  for (unsigned i = 0; i < pending.size(); ++i)
+    pending[i]->value->setPrefetched(results[pending[i]->key]);
+}
+
+template <class Result>
+collection<Result>
+PrefetchHelper<Result>::apply(Session& session,
+			      const collection<Result>& results,
+			      const std::vector<std::string>& relations)
+{
+  throw Exception("Query::prefetch(): only supported for a query "
+		  "that returns ptr<C>");
+}
+
+template <class C>
+collection< ptr<C> >
+PrefetchHelper< ptr<C> >::apply(Session& session,
+				const collection< ptr<C> >& results,
+				const std::vector<std::string>& relations)
+{
+  std::vector< ptr<C> > objects;
+
+  for (typename collection< ptr<C> >::const_iterator i = results.begin();
+       i != results.end(); ++i)
+    objects.push_back(*i);
+
+  for (unsigned i = 0; i < relations.size(); ++i) {
+    PrefetchAction action(session, relations[i]);
+
+    for (unsigned j = 0; j < objects.size(); ++j)
+      if (objects[j])
+	action.visit(objects[j]);
+
+    action.run();
+  }
+
+  return collection< ptr<C> >(&session, objects);
+}
+
+    }
+
   }
 }
 
@@ -349,14 +349,16 @@ namespace Impl {
 template <class Result>
 Query<Result, DynamicBinding>::Query()
   : limit_(-1),
-    offset_(-1)
+    offset_(-1),
+    streaming_(false)
 { }
 
 template <class Result>
 Query<Result, DynamicBinding>::Query(Session& session, const std::string& sql)
   : Impl::QueryBase<Result>(session, sql),
     limit_(-1),
-    offset_(-1)
+    offset_(-1),
+    streaming_(false)
 { }
 
 template <class Result>
@@ -365,7 +367,8 @@ Query<Result, DynamicBinding>::Query(Session& session,
 				     const std::string& where)
   : Impl::QueryBase<Result>(session, table, where),
     limit_(-1),
-    offset_(-1)
+    offset_(-1),
+    streaming_(false)
 { }
 
 template <class Result>
@@ -377,7 +380,9 @@ Query<Result, DynamicBinding>
     having_(other.having_),
     orderBy_(other.orderBy_),
     limit_(other.limit_),
-    offset_(other.offset_)
+    offset_(other.offset_),
+    streaming_(other.streaming_),
+    prefetch_(other.prefetch_)
 { 
   for (unsigned i = 0; i < other.parameters_.size(); ++i)
     parameters_.push_back(other.parameters_[i]->clone());
@@ -395,6 +400,8 @@ Query<Result, DynamicBinding>::operator=
   orderBy_ = other.orderBy_;
   limit_ = other.limit_;
   offset_ = other.offset_;
+  streaming_ = other.streaming_;
+  prefetch_ = other.prefetch_;
 
   reset();
 
@@ -485,6 +492,30 @@ int Query<Result, DynamicBinding>::limit() const
   return limit_;
 }
 
+template <class Result>
+Query<Result, DynamicBinding>&
+Query<Result, DynamicBinding>::streaming(bool enabled)
+{
+  streaming_ = enabled;
+
+  return *this;
+}
+
+template <class Result>
+bool Query<Result, DynamicBinding>::streaming() const
+{
+  return streaming_;
+}
+
+template <class Result>
+Query<Result, DynamicBinding>&
+Query<Result, DynamicBinding>::prefetch(const std::string& relation)
+{
+  prefetch_.push_back(relation);
+
+  return *this;
+}
+
 template <class Result>
 Result Query<Result, DynamicBinding>::resultValue() const
 {
@@ -507,6 +538,14 @@ collection<Result> Query<Result, DynamicBinding>::resultList() const
   bindParameters(statement);
   bindParameters(countStatement);
 
+  if (!prefetch_.empty()) {
+    collection<Result> results(this->session_, statement, countStatement);
+    return Impl::PrefetchHelper<Result>::apply(*this->session_, results,
+					       prefetch_);
+  }
+
+  statement->setStreaming(streaming_);
+
   return collection<Result>(this->session_, statement, countStatement);
 }
 
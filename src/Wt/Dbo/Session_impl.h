@@ -89,6 +89,19 @@ const std::string Session::tableNameQuoted() const
   return std::string("\"") + Impl::quoteSchemaDot(tableName<C>()) + '"';
 }
 
+template <class C>
+void Session::setObjectCache(ObjectCache *cache)
+{
+  typedef typename boost::remove_const<C>::type MutC;
+
+  ClassRegistry::iterator i = classRegistry_.find(&typeid(MutC));
+  if (i != classRegistry_.end())
+    i->second->objectCache = cache;
+  else
+    throw Exception(std::string("Class ") + typeid(MutC).name()
+		    + " was not mapped.");
+}
+
 template <class C>
 Session::Mapping<C> *Session::getMapping() const
 {
@@ -298,6 +311,9 @@ void Session::implSave(MetaDbo<C>& dbo)
   if (!transaction_)
     throw Exception("Dbo save(): no active transaction");
 
+  if (!dbo.inTransaction())
+    cacheInvalidate(dbo);
+
   if (!dbo.savedInTransaction())
     transaction_->objects_.push_back(new ptr<C>(&dbo));
 
@@ -306,7 +322,9 @@ void Session::implSave(MetaDbo<C>& dbo)
   SaveDbAction<C> action(dbo, *mapping);
   action.visit(*dbo.obj());
 
-  mapping->registry_[dbo.id()] = &dbo;
+  // a batched insert is registered once it has been executed
+  if (!action.batched())
+    mapping->registry_[dbo.id()] = &dbo;
 }
 
 template<class C>
@@ -315,6 +333,9 @@ void Session::implDelete(MetaDbo<C>& dbo)
   if (!transaction_)
     throw Exception("Dbo save(): no active transaction");
 
+  if (!dbo.inTransaction())
+    cacheInvalidate(dbo);
+
   // when saved in transaction, we are already in this list
   if (!dbo.savedInTransaction())
     transaction_->objects_.push_back(new ptr<C>(&dbo));
@@ -372,6 +393,43 @@ void Session::implLoad(MetaDbo<C>& dbo, SqlStatement *statement, int& column)
   }
 }
 
+/*
+ * A persisted object that is changed in a transaction is invalidated
+ * in the cache when it is first flushed, and released when the
+ * transaction is done.
+ */
+template <class C>
+void Session::cacheInvalidate(MetaDbo<C>& dbo)
+{
+  Mapping<C> *mapping = getMapping<C>();
+
+  if (mapping->objectCache && !dbo.isNew())
+    mapping->objectCache->invalidate
+      (mapping->tableName, boost::lexical_cast<std::string>(dbo.id()));
+}
+
+template <class C>
+void Session::cacheRelease(MetaDbo<C>& dbo, bool success)
+{
+  Mapping<C> *mapping = getMapping<C>();
+
+  if (mapping->objectCache && !dbo.isNew() && dbo.inTransaction())
+    mapping->objectCache->release
+      (mapping->tableName, boost::lexical_cast<std::string>(dbo.id()),
+       success,
+       mapping->versionFieldName && dbo.isLoaded() ? dbo.version() + 1 : -1);
+}
+
+template <class C>
+void Session::cacheDiscard(MetaDbo<C>& dbo)
+{
+  Mapping<C> *mapping = getMapping<C>();
+
+  if (mapping->objectCache)
+    mapping->objectCache->discard
+      (mapping->tableName, boost::lexical_cast<std::string>(dbo.id()));
+}
+
 template <class C>
 Session::Mapping<C>::~Mapping()
 {
@@ -432,6 +490,13 @@ MetaDbo<C> *Session::Mapping<C>::load(Session& session, SqlStatement *statement,
     ::load(&session, statement, column);
 }
 
+template <class C>
+void Session::Mapping<C>::registerSaved(MetaDboBase *obj)
+{
+  MetaDbo<C> *dbo = dynamic_cast<MetaDbo<C> *>(obj);
+  registry_[dbo->id()] = dbo;
+}
+
 template <class C>
 void Session::Mapping<C>::init(Session& session)
 {
@@ -144,7 +144,9 @@ shared_impl::shared_impl(const collection<C>& collection,
     useCount_(0),
     queryEnded_(false),
     posPastQuery_(0),
-    ended_(false)
+    ended_(false),
+    prefetched_(statement ? 0 : collection.prefetched()),
+    posPrefetched_(0)
 {
   fetchNextRow();
 }
@@ -172,6 +174,17 @@ void collection<C>::iterator::shared_impl::fetchNextRow()
     return;
   }
 
+  if (prefetched_) {
+    if (posPrefetched_ < prefetched_->size()) {
+      current_ = (*prefetched_)[posPrefetched_++];
+
+      Impl::Helper<C>::skipIfRemoved(*this);
+      return;
+    }
+
+    prefetched_ = 0;
+  }
+
   if (!statement_ || !statement_->nextRow()) {
     queryEnded_ = true;
     if (collection_.manualModeInsertions().size() == 0)
@@ -287,7 +300,9 @@ collection<C>::const_iterator::const_iterator(const collection<C>& collection,
 template <class C>
 collection<C>::collection()
   : session_(0),
-    type_(RelationCollection)
+    type_(RelationCollection),
+    prefetched_(0),
+    prefetchedChangeCount_(0)
 {
   data_.relation.sql = 0;
   data_.relation.dbo = 0;
@@ -299,7 +314,9 @@ template <class C>
 collection<C>::collection(Session *session, SqlStatement *statement,
 			  SqlStatement *countStatement)
   : session_(session),
-    type_(QueryCollection)
+    type_(QueryCollection),
+    prefetched_(0),
+    prefetchedChangeCount_(0)
 {
   data_.query = new QueryData();
   data_.query->useCount = 1;
@@ -308,11 +325,27 @@ collection<C>::collection(Session *session, SqlStatement *statement,
   data_.query->size = -1;
 }
 
+template <class C>
+collection<C>::collection(Session *session, const std::vector<C>& results)
+  : session_(session),
+    type_(QueryCollection),
+    prefetched_(new std::vector<C>(results)),
+    prefetchedChangeCount_(0)
+{
+  data_.query = new QueryData();
+  data_.query->useCount = 1;
+  data_.query->statement = 0;
+  data_.query->countStatement = 0;
+  data_.query->size = static_cast<int>(results.size());
+}
+
 template <class C>
 collection<C>::collection(const collection<C>& other)
   : session_(other.session_),
     type_(other.type_),
-    data_(other.data_)
+    data_(other.data_),
+    prefetched_(other.prefetched_ ? new std::vector<C>(*other.prefetched_) : 0),
+    prefetchedChangeCount_(other.prefetchedChangeCount_)
 {
   if (type_ == RelationCollection)
     data_.relation.activity = 0;
@@ -345,7 +378,14 @@ collection<C>& collection<C>::operator=(const collection<C>& other)
   session_ = other.session_;
   type_ = other.type_;
   data_ = other.data_;
-  
+
+  if (&other != this) {
+    delete prefetched_;
+    prefetched_ = other.prefetched_
+      ? new std::vector<C>(*other.prefetched_) : 0;
+    prefetchedChangeCount_ = other.prefetchedChangeCount_;
+  }
+
   if (type_ == RelationCollection)
     data_.relation.activity = 0;
   else
@@ -361,6 +401,8 @@ collection<C>::~collection()
     delete data_.relation.activity;
   else
     releaseQuery();
+
+  delete prefetched_;
 }
 
 template <class C>
@@ -378,6 +420,9 @@ SqlStatement *collection<C>::executeStatement() const
   if (session_ && session_->flushMode() == Auto)
     session_->flush();
 
+  if (prefetched())
+    return 0;
+
   if (type_ == QueryCollection)
     statement = data_.query->statement;
   else {
@@ -441,6 +486,10 @@ typename collection<C>::size_type collection<C>::size() const
   if (session_ && session_->flushMode() == Auto)
     session_->flush();
 
+  if (prefetched())
+    return prefetched()->size()
+      + manualModeInsertions_.size() - manualModeRemovals_.size();
+
   if (type_ == QueryCollection)
     countStatement = data_.query->countStatement;
   else {
@@ -519,6 +568,8 @@ void collection<C>::insert(C c)
     throw Exception("collection<C>::insert() only for a relational "
 		    "collection.");
 
+  discardPrefetched();
+
   if (session_->flushMode() == Auto) {
     if (relation.dbo) {
       relation.dbo->setDirty();
@@ -553,6 +604,8 @@ void collection<C>::erase(C c)
   if (type_ != RelationCollection || relation.setInfo == 0)
     throw Exception("collection<C>::erase() only for a relational relation.");
 
+  discardPrefetched();
+
   if (relation.dbo)
     relation.dbo->setDirty();
 
@@ -588,6 +641,8 @@ void collection<C>::clear()
   if (type_ != RelationCollection || relation.setInfo == 0)
     throw Exception("collection<C>::clear() only for a relational relation.");
 
+  discardPrefetched();
+
   if (relation.setInfo->type == ManyToMany) {
     if (relation.activity) {
       relation.activity->transactionInserted.clear();
@@ -669,6 +724,38 @@ void collection<C>::setRelationData(MetaDboBase *dbo,
   data_.relation.sql = sql;
   data_.relation.dbo = dbo;
   data_.relation.setInfo = setInfo;
+
+  discardPrefetched();
+}
+
+template <class C>
+const std::vector<C> *collection<C>::prefetched() const
+{
+  /*
+   * The prefetched contents of a relation are valid until changes are
+   * flushed, or the transaction ends.
+   */
+  if (prefetched_
+      && (type_ == QueryCollection
+	  || (session_ && session_->changeCount_ == prefetchedChangeCount_)))
+    return prefetched_;
+  else
+    return 0;
+}
+
+template <class C>
+void collection<C>::setPrefetched(const std::vector<C>& results)
+{
+  delete prefetched_;
+  prefetched_ = new std::vector<C>(results);
+  prefetchedChangeCount_ = session_ ? session_->changeCount_ : 0;
+}
+
+template <class C>
+void collection<C>::discardPrefetched()
+{
+  delete prefetched_;
+  prefetched_ = 0;
 }
 
   }
@@ -133,6 +133,8 @@ void MetaDbo<C>::doTransactionDone(bool success)
 {
   Session *s = session();
 
+  s->cacheRelease(*this, success);
+
   if (success) {
     if (deletedInTransaction()) {
       prune();
@@ -186,6 +188,7 @@ void MetaDbo<C>::reread()
   checkNotOrphaned();
   if (isPersisted()) {
     session()->discardChanges(this);
+    session()->cacheDiscard(*this);
 
     delete obj_;
     obj_ = 0;
@@ -43,6 +43,7 @@ public:
   std::vector<std::string> options() const;
 
   int threads() const { return threads_; }
+  int ioThreads() const { return ioThreads_; }
   const std::string& docRoot() const { return docRoot_; }
   const std::string& appRoot() const { return appRoot_; }
   bool defaultStatic() const { return defaultStatic_; }
@@ -53,6 +54,10 @@ public:
   const std::string& pidPath() const { return pidPath_; }
   const std::string& serverName() const { return serverName_; }
   bool compression() const { return compression_; }
+  int compressionLevel(const std::string& contentType) const;
+  ::int64_t compressionMinSize() const { return compressionMinSize_; }
+  bool sendFile() const { return sendFile_; }
+  bool http2() const { return http2_; }
   bool gdb() const { return gdb_; }
   const std::string& configPath() const { return configPath_; }
 
@@ -75,11 +80,16 @@ public:
 
   const std::string& sessionIdPrefix() const { return sessionIdPrefix_; }
   const std::string& accessLog() const { return accessLog_; }
+  bool accessLogAsync() const { return accessLogAsync_; }
 
   int parentPort() const { return parentPort_; }
 
   ::int64_t maxMemoryRequestSize() const { return maxMemoryRequestSize_; }
 
+  ::int64_t staticCacheSize() const { return staticCacheSize_; }
+  ::int64_t staticCacheFileSize() const { return staticCacheFileSize_; }
+  int staticCacheRevalidate() const { return staticCacheRevalidate_; }
+
   // ssl Password callback is not configurable from a file but we store it
   // here because it's used in the Server constructor (inside start())
   void setSslPasswordCallback(
@@ -97,6 +107,7 @@ private:
   bool silent_;
 
   int threads_;
+  int ioThreads_;
   std::string docRoot_, appRoot_;
   bool defaultStatic_;
   std::vector<std::string> staticPaths_;
@@ -105,6 +116,11 @@ private:
   std::string pidPath_;
   std::string serverName_;
   bool compression_;
+  int compressionLevel_;
+  std::vector<std::pair<std::string, int> > compressionTypeLevels_;
+  ::int64_t compressionMinSize_;
+  bool sendFile_;
+  bool http2_;
   bool gdb_;
   std::string configPath_;
 
@@ -125,11 +141,16 @@ private:
 
   std::string sessionIdPrefix_;
   std::string accessLog_;
+  bool accessLogAsync_;
 
   int parentPort_;
 
   ::int64_t maxMemoryRequestSize_;
 
+  ::int64_t staticCacheSize_;
+  ::int64_t staticCacheFileSize_;
+  int staticCacheRevalidate_;
+
   boost::function<std::string (std::size_t max_length, int purpose)> sslPasswordCallback_;
 
   void createOptions(po::options_description& options, po::options_description& visible_options);
@@ -140,6 +161,7 @@ private:
 		 std::string& result, int options);
   void checkPath(std::string& result, std::string varDescription,
 		 int options);
+  static int parseCompressionLevel(const std::string& level);
 
   enum PathOptions { RegularFile = 0x1,
 		     Directory = 0x2,
@@ -30,6 +30,7 @@ typedef boost::asio::deadline_timer asio_timer;
 
 #include <boost/array.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/enable_shared_from_this.hpp>
 
@@ -45,6 +46,7 @@ namespace http {
 namespace server {
 
 class ConnectionManager;
+class Http2Session;
 class Server;
 
 /// Represents a single connection from a client.
@@ -69,6 +71,9 @@ public:
   /// Like CGI's Url scheme: http or https
   virtual const char *urlScheme() = 0;
 
+  /// Whether file content may be written directly using sendfile()
+  virtual bool sendFileSupported() { return false; }
+
   virtual ~Connection();
 
   Server *server() const { return server_; }
@@ -94,6 +99,12 @@ public:
   void detectDisconnect(ReplyPtr reply,
 			const boost::function<void()>& callback);
 
+  /// Whether the connection switched to HTTP/2
+  bool http2() const { return http2_.get() != 0; }
+
+  /// HTTP/2: writes frames, the session is notified when done
+  void startWriteFrames(const std::vector<asio::const_buffer>& buffers);
+
 protected:
   void handleWriteResponse(ReplyPtr reply,
 			   const asio_error_code& e,
@@ -146,11 +157,21 @@ private:
 			      const std::vector<asio::const_buffer>& buffers, 
 				       int timeout) = 0;
 
+  /*
+   * Asynchronously writing a file region of a response, only used if
+   * sendFileSupported()
+   */
+  virtual void startAsyncSendFile(ReplyPtr reply,
+				  const Reply::FileRegion& region,
+				  int timeout);
+
   /// Generic I/O error handling: closes the connection and cancels timers
   void handleError(const asio_error_code& e);
 
   void sendStockReply(Reply::status_type code);
 
+  void startHttp2();
+
   /// The handler used to process the incoming request.
   RequestHandler& request_handler_;
 
@@ -196,6 +217,9 @@ private:
   bool responseDone_;
 
   boost::function<void()> disconnectCallback_;
+
+  /// The HTTP/2 session, after the client sent the connection preface
+  boost::scoped_ptr<Http2Session> http2_;
 };
 
 typedef boost::shared_ptr<Connection> ConnectionPtr;
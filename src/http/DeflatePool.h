@@ -0,0 +1,67 @@
+// This may look like C code, but it's really -*- C++ -*-
+/*
+ * Copyright (C) 2016 Emweb bvba, Herent, Belgium.
+ *
+ * All rights reserved.
+ */
+
+#ifndef HTTP_DEFLATE_POOL_HPP
+#define HTTP_DEFLATE_POOL_HPP
+
+#ifdef WTHTTP_WITH_ZLIB
+
+#include <zlib.h>
+
+#include "WHttpDllDefs.h"
+
+namespace http {
+namespace server {
+
+/// A pool of zlib streams that produce gzip encoded output.
+/*
+ * Initializing a deflate stream allocates about 256 kB of state,
+ * which is significant compared to the size of a typical (Ajax)
+ * response. Instead, streams are kept in a small per-thread free
+ * list and are reset (and if needed reconfigured for another
+ * compression level) when they are reused.
+ *
+ * A stream may be released from another thread than the one that
+ * acquired it; it is then added to the pool of the releasing thread.
+ */
+class WTHTTP_API DeflatePool
+{
+public:
+  struct Stream {
+    z_stream strm;
+    int level;
+  };
+
+  /*
+   * Returns a stream, ready to compress a new gzip member at the
+   * given level.
+   */
+  static Stream *acquire(int level);
+
+  /*
+   * Returns a stream to the pool. It does not need to have finished
+   * compressing.
+   */
+  static void release(Stream *stream);
+
+  /*
+   * Returns the number of streams that are pooled for the current
+   * thread.
+   */
+  static int pooled();
+
+private:
+  class ThreadPool;
+  static ThreadPool& threadPool();
+};
+
+} // namespace server
+} // namespace http
+
+#endif // WTHTTP_WITH_ZLIB
+
+#endif // HTTP_DEFLATE_POOL_HPP
@@ -0,0 +1,137 @@
+// This may look like C code, but it's really -*- C++ -*-
+/*
+ * Copyright (C) 2016 Emweb bvba, Herent, Belgium.
+ *
+ * All rights reserved.
+ */
+
+#ifndef HTTP_HPACK_HPP
+#define HTTP_HPACK_HPP
+
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "WHttpDllDefs.h"
+
+namespace http {
+namespace server {
+
+/// Header compression for HTTP/2 (HPACK, RFC 7541).
+namespace Hpack {
+
+typedef std::pair<std::string, std::string> HeaderField;
+typedef std::vector<HeaderField> HeaderList;
+
+/*
+ * The dynamic table, shared by the encoder and decoder. Entries are
+ * evicted (oldest first) to keep the size within the maximum.
+ */
+class WTHTTP_API Table
+{
+public:
+  Table();
+
+  void setMaxSize(std::size_t size);
+  std::size_t maxSize() const { return maxSize_; }
+  std::size_t size() const { return size_; }
+
+  void add(const std::string& name, const std::string& value);
+
+  /*
+   * Returns the entry for an HPACK index (1 .. 61 are the static
+   * table, from 62 on the dynamic table), or 0 if the index is invalid.
+   */
+  const HeaderField *entry(std::size_t index) const;
+
+  /*
+   * Finds an entry, returns its index or 0 if not found. If only the
+   * name matches, nameIndex is set.
+   */
+  std::size_t find(const std::string& name, const std::string& value,
+		   std::size_t& nameIndex) const;
+
+private:
+  std::deque<HeaderField> entries_; // newest first
+  std::size_t size_, maxSize_;
+
+  void evict(std::size_t maxSize);
+};
+
+class WTHTTP_API Decoder
+{
+public:
+  Decoder();
+
+  /*
+   * The maximum table size which the encoder may choose, as advertised
+   * in our SETTINGS_HEADER_TABLE_SIZE (the default is 4096).
+   */
+  void setMaxTableSize(std::size_t size);
+
+  /*
+   * The maximum size of a decoded header list (the length of the
+   * names and values, plus 32 for each field), as advertised in our
+   * SETTINGS_MAX_HEADER_LIST_SIZE. The default, 0, is unlimited.
+   */
+  void setMaxHeaderListSize(std::size_t size);
+  std::size_t maxHeaderListSize() const { return maxHeaderListSize_; }
+
+  /*
+   * Decodes a complete header block, appending to result. Returns
+   * false if the block could not be decoded, or decodes to a larger
+   * header list than allowed: since the decoder state is then
+   * unknown, this is fatal for the connection.
+   */
+  bool decode(const unsigned char *data, std::size_t size,
+	      HeaderList& result);
+
+private:
+  Table table_;
+  std::size_t maxTableSize_, maxHeaderListSize_;
+};
+
+class WTHTTP_API Encoder
+{
+public:
+  Encoder();
+
+  /*
+   * Sets the maximum table size as advertised by the peer in its
+   * SETTINGS_HEADER_TABLE_SIZE. The next header block will signal
+   * the size that is used.
+   */
+  void setMaxTableSize(std::size_t size);
+
+  /*
+   * Encodes a header block, appending to result. Names must be
+   * lowercase.
+   */
+  void encode(const HeaderList& headers, std::string& result);
+
+private:
+  Table table_;
+  std::size_t pendingTableSize_;
+  bool tableSizeChanged_;
+};
+
+/*
+ * Primitives, exposed for testing.
+ */
+extern WTHTTP_API void encodeInteger(std::string& result, unsigned char bits,
+				     int prefix, std::size_t value);
+extern WTHTTP_API bool decodeInteger(const unsigned char *& data,
+				     const unsigned char *end, int prefix,
+				     std::size_t& value);
+extern WTHTTP_API void huffmanEncode(std::string& result,
+				     const std::string& s);
+extern WTHTTP_API bool huffmanDecode(const unsigned char *data,
+				     std::size_t size, std::string& result);
+
+}
+
+} // namespace server
+} // namespace http
+
+#endif // HTTP_HPACK_HPP
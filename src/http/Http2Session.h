@@ -0,0 +1,183 @@
+// This may look like C code, but it's really -*- C++ -*-
+/*
+ * Copyright (C) 2016 Emweb bvba, Herent, Belgium.
+ *
+ * All rights reserved.
+ */
+
+#ifndef HTTP_HTTP2_SESSION_HPP
+#define HTTP_HTTP2_SESSION_HPP
+
+#include <deque>
+#include <list>
+#include <string>
+#include <vector>
+
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+
+#include "Hpack.h"
+#include "Reply.h"
+#include "Request.h"
+#include "RequestParser.h"
+
+namespace http {
+namespace server {
+
+class Connection;
+class RequestHandler;
+
+/*
+ * The HTTP/2 protocol (RFC 7540) on a connection, after the client
+ * sent the connection preface.
+ *
+ * Each stream has its own Request and Reply, and the replies are
+ * used in the same way as for HTTP/1.1: send(), receive() and
+ * detectDisconnect() are routed here by the connection, and a reply
+ * gets writeDone() when the data it provided has been written. The
+ * response is framed using Reply::nextHttp2Buffers().
+ *
+ * All methods are called from within the connection's strand.
+ */
+class Http2Session : private boost::noncopyable
+{
+public:
+  /*
+   * The connection's request provides the client address and SSL
+   * handle for the requests on the streams.
+   */
+  Http2Session(Connection& connection, const Request& connectionRequest,
+	       RequestHandler& handler);
+  ~Http2Session();
+
+  /*
+   * Processes received data. The first data follows the
+   * "PRI * HTTP/2.0" request line of the connection preface.
+   */
+  void consume(const char *begin, const char *end);
+
+  /*
+   * Returns whether the connection should keep reading: this is false
+   * once the session is closing.
+   */
+  bool reading() const { return !closing_ && !stopped_; }
+
+  /*
+   * Returns whether no streams are open.
+   */
+  bool idle() const { return streams_.empty(); }
+
+  void startWriteResponse(ReplyPtr reply);
+  void readMore(ReplyPtr reply);
+  void detectDisconnect(ReplyPtr reply,
+			const boost::function<void()>& callback);
+
+  /*
+   * Called when the data passed to Connection::startWriteFrames() has
+   * been written.
+   */
+  void writeDone(bool success);
+
+  /*
+   * The connection is stopped: aborts all streams.
+   */
+  void stop();
+
+private:
+  struct Stream;
+
+  Connection& connection_;
+  const Request& connectionRequest_;
+  RequestHandler& handler_;
+  RequestParser parser_;
+
+  Hpack::Decoder decoder_;
+  Hpack::Encoder encoder_;
+
+  // received data that does not yet form a complete frame
+  std::string in_;
+  bool prefaceReceived_;
+
+  // header block that is being received (HEADERS + CONTINUATION)
+  std::string headerBlock_;
+  unsigned headerStreamId_;
+  bool headerEndStream_;
+
+  std::vector<Stream *> streams_; // open streams, by increasing id
+  std::vector<Stream *> free_;    // closed streams, for reuse
+  unsigned lastStreamId_;
+  unsigned nextStream_;           // round-robin position for sending
+
+  // flow control
+  long connSendWindow_, connRecvWindow_;
+  long connRecvConsumed_;
+  long peerInitialWindow_;
+  std::size_t peerMaxFrameSize_;
+
+  // frames other than DATA, waiting for the next write
+  std::string control_;
+
+  /*
+   * A reply with data in the write in progress, which refers to its
+   * buffers: it is held until the write completes, even when the
+   * stream is closed meanwhile. If done, the reply gets writeDone()
+   * when the write completes.
+   */
+  struct WrittenReply {
+    unsigned streamId;
+    ReplyPtr reply;
+    bool done;
+
+    WrittenReply(unsigned id, const ReplyPtr& r, bool d)
+      : streamId(id), reply(r), done(d) { }
+  };
+
+  // the write in progress
+  bool writing_;
+  std::list<std::string> writeBufs_;
+  std::vector<WrittenReply> written_;
+
+  bool goingAway_, closing_, stopped_;
+
+  void processFrame(unsigned char type, unsigned char flags,
+		    unsigned streamId, const char *payload,
+		    std::size_t length);
+  void processData(unsigned char flags, unsigned streamId,
+		   const char *payload, std::size_t length);
+  void processHeaders(unsigned char flags, unsigned streamId,
+		      const char *payload, std::size_t length);
+  void processSettings(unsigned char flags, const char *payload,
+		       std::size_t length);
+  void processWindowUpdate(unsigned streamId, const char *payload,
+			   std::size_t length);
+  void headersComplete();
+
+  bool setupRequest(Stream& stream, const Hpack::HeaderList& fields,
+		    bool endStream);
+  void startRequest(Stream& stream, bool endStream);
+  void deliverBody(Stream& stream, const char *data, std::size_t size);
+  void bodyConsumed(Stream *stream, std::size_t size);
+
+  Stream *findStream(unsigned id) const;
+  Stream *findStream(const ReplyPtr& reply) const;
+  Stream *openStream(unsigned id);
+  void closeStream(Stream& stream);
+  void abortStream(Stream& stream);
+  void finishSending(Stream& stream);
+
+  void queueData(Stream& stream, std::vector<asio::const_buffer>& buffers,
+		 std::size_t& budget);
+  void flush();
+
+  void appendFrameHeader(std::string& out, std::size_t length,
+			 unsigned char type, unsigned char flags,
+			 unsigned streamId);
+  void queueWindowUpdate(unsigned streamId, long increment);
+  void streamError(unsigned streamId, unsigned errorCode);
+  void connectionError(unsigned errorCode);
+};
+
+} // namespace server
+} // namespace http
+
+#endif // HTTP_HTTP2_SESSION_HPP
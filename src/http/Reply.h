@@ -39,6 +39,8 @@ namespace asio = boost::asio;
 #include "../web/Configuration.h"
 
 #include "Buffer.h"
+#include "DeflatePool.h"
+#include "Hpack.h"
 #include "WHttpDllDefs.h"
 #include "Request.h"
 
@@ -88,6 +90,16 @@ public:
     version_not_supported = 505
   };
 
+  /*
+   * A part of an open file that is transmitted directly from the file
+   * descriptor to the socket (using sendfile()).
+   */
+  struct FileRegion {
+    int fd;
+    ::int64_t offset;
+    ::int64_t size;
+  };
+
   enum ws_opcode {
     continuation = 0x0,
     text_frame = 0x1,
@@ -120,6 +132,15 @@ public:
   void setConnection(ConnectionPtr connection);
   bool nextWrappedContentBuffers(std::vector<asio::const_buffer>& result);
   bool nextBuffers(std::vector<asio::const_buffer>& result);
+
+  /*
+   * Like nextBuffers(), but for HTTP/2: the first call provides the
+   * response headers, and the content is not chunked since it is
+   * framed by the HTTP/2 session.
+   */
+  bool nextHttp2Buffers(Hpack::HeaderList& headers,
+			std::vector<asio::const_buffer>& result);
+  bool nextFileRegion(FileRegion& result);
   bool closeConnection() const;
   void setCloseConnection() { closeConnection_ = true; }
   void detectDisconnect(const boost::function<void()>& callback);
@@ -136,6 +157,8 @@ public:
   void setStatus(status_type status);
   status_type status() const { return status_; }
 
+  static std::string httpDate(time_t t);
+
 protected:
   Request& request_;
   const Configuration& configuration_;
@@ -151,11 +174,17 @@ protected:
   virtual bool nextContentBuffers(std::vector<asio::const_buffer>& result)
     = 0;
 
+  /*
+   * Provides the next file region to send instead of content buffers,
+   * when the connection supports it. Is only considered after the
+   * headers have been sent, and when the content is not chunked or
+   * compressed. Returns false if there is no file region to send.
+   */
+  virtual bool nextContentFileRegion(FileRegion& result);
+
   void setRelay(ReplyPtr reply);
   ReplyPtr relay() const { return relay_; }
 
-  static std::string httpDate(time_t t);
-
   ConnectionPtr connection() const { return connection_; }
   bool transmitting() const { return transmitting_; }
   asio::const_buffer buf(const std::string &s);
@@ -186,10 +215,16 @@ private:
 
   bool encodeNextContentBuffer(std::vector<asio::const_buffer>& result,
 			       int& originalSize, int& encodedSize);
+  bool startGzip(const std::string& contentType, ::int64_t contentLength,
+		 bool haveContentEncoding);
 #ifdef WTHTTP_WITH_ZLIB
-  void initGzip();
-  bool gzipBusy_;
-  z_stream gzipStrm_;
+  void initGzip(int level);
+  void endGzip();
+  DeflatePool::Stream *gzip_;
+
+  // content that was fetched before the headers, to decide on compression
+  std::vector<asio::const_buffer> peekedBuffers_;
+  bool havePeeked_, peekedLastData_;
 #endif
 };
 
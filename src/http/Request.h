@@ -17,6 +17,7 @@
 #ifndef HTTP_REQUEST_HPP
 #define HTTP_REQUEST_HPP
 
+#include <deque>
 #include <string>
 #include <map>
 #include <vector>
@@ -26,6 +27,8 @@
 // For ::int64_ and ::uint64_t on Windows only
 #include "Wt/WDllDefs.h"
 
+#include "WHttpDllDefs.h"
+
 #ifdef HTTP_WITH_SSL
 #include <openssl/ssl.h>
 #endif
@@ -69,13 +72,46 @@ std::ostream& operator<< (std::ostream &os, const buffer_string &str);
 
 /// A request received from a client.
 /// A request with a body will have a content-length.
-class Request
+class WTHTTP_API Request
 {
 public:
   struct Header {
     buffer_string name;
     buffer_string value;
   };
+
+  /*
+   * Headers that are looked up by wthttp or Wt itself: these are
+   * indexed when the request headers have been parsed.
+   */
+  enum KnownHeader {
+    HostHeader,
+    ConnectionHeader,
+    UpgradeHeader,
+    CookieHeader,
+    UserAgentHeader,
+    RefererHeader,
+    AcceptHeader,
+    AcceptEncodingHeader,
+    AcceptLanguageHeader,
+    AuthorizationHeader,
+    ContentTypeHeader,
+    ContentLengthHeader,
+    RangeHeader,
+    IfNoneMatchHeader,
+    IfModifiedSinceHeader,
+    OriginHeader,
+    ClientIPHeader,
+    XForwardedForHeader,
+    XForwardedHostHeader,
+    XForwardedProtoHeader,
+    SecWebSocketKeyHeader,
+    SecWebSocketKey1Header,
+    SecWebSocketKey2Header,
+    SecWebSocketVersionHeader,
+    SecWebSocketExtensionsHeader,
+    KnownHeaderCount
+  };
   
 #ifdef WTHTTP_WITH_ZLIB
   struct PerMessageDeflateState {
@@ -91,6 +127,8 @@ public:
 #endif
     http_version_major = -1;
     http_version_minor = -1;
+    headers.reserve(16);
+    clearHeaderIndex();
   }
   enum State { Partial, Complete, Error };
 
@@ -102,8 +140,21 @@ public:
   int http_version_major;
   int http_version_minor;
 
-  typedef std::list<Header> HeaderList;
+  /*
+   * The request is reused for all requests on a connection, and so
+   * is the storage for the headers. A header value may refer to
+   * another header value when values of the same header are
+   * concatenated, thus headers may not be added after process().
+   */
+  typedef std::vector<Header> HeaderList;
   HeaderList headers;
+
+  /*
+   * Parts of header names and values that span several receive
+   * buffers (these need stable addresses while parsing).
+   */
+  std::deque<buffer_string> continuations;
+
   ::int64_t contentLength;
   int webSocketVersion;
 #ifdef WTHTTP_WITH_ZLIB
@@ -133,6 +184,18 @@ public:
   void enableWebSocket();
   const Header *getHeader(const std::string& name) const;
   const Header *getHeader(const char *name) const;
+  const Header *getHeader(KnownHeader header) const;
+
+  static int knownHeader(const char *name, unsigned length);
+
+private:
+  // index in headers, or -1; only valid after process()
+  int knownHeaders_[KnownHeaderCount];
+  bool indexed_;
+
+  void clearHeaderIndex();
+  void concatenate(buffer_string& value, buffer_string& other);
+  const Header *findHeader(const char *name) const;
 };
 
 } // namespace server
@@ -24,6 +24,7 @@
 
 #include "Configuration.h"
 #include "SessionProcessManager.h"
+#include "StaticFileCache.h"
 #include "WtReply.h"
 #include "../web/Configuration.h"
 
@@ -57,6 +58,8 @@ public:
 
   void setSessionManager(SessionProcessManager *sessionManager);
 
+  const StaticFileCache& staticFileCache() const { return staticFileCache_; }
+
 private:
   /// The server configuration
   const Configuration &config_;
@@ -66,6 +69,8 @@ private:
   Wt::WLogger& logger_;
   /// The session manager for dedicated processes
   SessionProcessManager *sessionManager_;
+  /// The cache for small static files
+  StaticFileCache staticFileCache_;
 
   /// Perform URL-decoding on a string and separates in path and
   /// query. Returns false if the encoding was invalid.
@@ -34,7 +34,7 @@ class Request;
 class Server;
 
 /// Parser for incoming requests.
-class RequestParser
+class WTHTTP_API RequestParser
 {
 public:
   enum ParseResult {
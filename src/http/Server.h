@@ -24,6 +24,7 @@ namespace asio = boost::asio;
 #endif // HTTP_WITH_SSL
 
 #include <string>
+#include <vector>
 #include <boost/noncopyable.hpp>
 #include <boost/version.hpp>
 
@@ -80,12 +81,54 @@ public:
 
   asio::io_service &service();
 
+  /// Whether connections are served by reactor threads (--io-threads),
+  /// in which case request handling is posted to service()
+  bool hasReactors() const { return !reactors_.empty(); }
+
   SessionProcessManager *sessionManager() { return sessionManager_; }
 
+  const StaticFileCache& staticFileCache() const
+  { return request_handler_.staticFileCache(); }
+
 private:
   /// Starts accepting http/https connections
   void startAccept();
 
+  /// Opens an acceptor and starts listening
+  void openAcceptor(asio::ip::tcp::acceptor& acceptor,
+		    const asio::ip::tcp::endpoint& endpoint,
+		    bool reusePort);
+
+  /// A thread with its own io_service and acceptors (--io-threads)
+  struct Reactor;
+
+  /// Creates the reactors, or reopens their acceptors on resume
+  void startReactors(const asio::ip::tcp::endpoint *tcpEndpoint,
+		     const asio::ip::tcp::endpoint *sslEndpoint);
+
+  /// Opens the acceptors of a reactor and starts accepting
+  void openReactorAcceptors(Reactor *reactor);
+
+  /// Same as openReactorAcceptors(), but from within the reactor thread
+  void reopenReactorAcceptors(Reactor *reactor);
+
+  /// Starts accepting connections in a reactor
+  void reactorStartAccept(Reactor *reactor);
+
+  /// Handle completion of an accept operation in a reactor
+  void handleReactorTcpAccept(Reactor *reactor, const asio_error_code& e);
+
+#ifdef HTTP_WITH_SSL
+  /// Handle completion of an SSL accept operation in a reactor
+  void handleReactorSslAccept(Reactor *reactor, const asio_error_code& e);
+#endif // HTTP_WITH_SSL
+
+  /// Closes the acceptors of a reactor
+  void closeReactorAcceptors(Reactor *reactor);
+
+  /// Stops the reactor threads and destroys their connections
+  void stopReactors();
+
   /// Start to connect to a listening TCP socket of the parent
   /// Used for dedicated processes.
   void startConnect(const boost::shared_ptr<asio::ip::tcp::socket>& socket);
@@ -158,6 +201,13 @@ void handleTimeout(asio_timer *timer,
   /// For dedicated process deployment: timer to periodically
   /// call WebController::expireSessions()
   asio_timer expireSessionsTimer_;
+
+  /// The reactors, when connections are not served by the thread pool
+  std::vector<Reactor *> reactors_;
+
+  /// The endpoints on which each reactor accepts connections
+  asio::ip::tcp::endpoint reactorTcpEndpoint_, reactorSslEndpoint_;
+  bool reactorTcp_, reactorSsl_;
 };
 
 } // namespace server
@@ -0,0 +1,121 @@
+// This may look like C code, but it's really -*- C++ -*-
+/*
+ * Copyright (C) 2016 Emweb bvba, Herent, Belgium.
+ *
+ * All rights reserved.
+ */
+
+#ifndef HTTP_STATIC_FILE_CACHE_HPP
+#define HTTP_STATIC_FILE_CACHE_HPP
+
+#include <ctime>
+#include <list>
+#include <map>
+#include <string>
+
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+// For ::int64_t and ::uint64_t on Windows only, and WT_THREADED
+#include "Wt/WDllDefs.h"
+
+#ifdef WT_THREADED
+#include <boost/thread/mutex.hpp>
+#endif // WT_THREADED
+
+namespace http {
+namespace server {
+
+class Configuration;
+
+/// Keeps small static files in memory, together with their headers.
+/*
+ * Files are kept in a size-bounded LRU list. A cached file is checked
+ * against the file system (modification time and size) at most once
+ * every Configuration::staticCacheRevalidate() seconds, so that hot
+ * files are served without any system call.
+ *
+ * Besides the file contents, an entry keeps a gzip variant: either
+ * the precompressed '.gz' file next to it, or a variant that is
+ * compressed the first time it is requested by a client that accepts
+ * gzip.
+ */
+class StaticFileCache
+  : private boost::noncopyable
+{
+public:
+  /// The (immutable) contents of a cached file, with its header values
+  struct File {
+    std::string data;
+    std::string etag;
+    std::string modifiedDate;
+  };
+
+  typedef boost::shared_ptr<const File> FilePtr;
+
+  StaticFileCache(const Configuration& config);
+
+  /*
+   * Returns the file at path, from the cache or after loading it in
+   * the cache. If acceptGzip, the gzip variant is returned when
+   * available, which is indicated in gzipped.
+   *
+   * Returns 0 if the file is not (or cannot be) cached.
+   */
+  FilePtr get(const std::string& path, const std::string& contentType,
+	      bool acceptGzip, bool& gzipped);
+
+  ::int64_t hits() const;
+  ::int64_t misses() const;
+  int files() const;
+  ::int64_t size() const;
+
+private:
+  struct Entry {
+    FilePtr file, gzipFile;
+    bool gzipChecked; // gzipFile is final
+    std::time_t mtime, gzipMtime; // gzipMtime = -1: no '.gz' file
+    ::int64_t fileSize;
+  };
+
+  typedef boost::shared_ptr<const Entry> EntryPtr;
+  typedef std::list<std::string> LruList;
+
+  struct Item {
+    EntryPtr entry;
+    std::time_t validated;
+    LruList::iterator lru;
+  };
+
+  typedef std::map<std::string, Item> ItemMap;
+
+  const Configuration& config_;
+
+#ifdef WT_THREADED
+  mutable boost::mutex mutex_;
+#endif // WT_THREADED
+
+  ItemMap items_;
+  LruList lru_; // most recently used first
+  ::int64_t size_, hits_, misses_;
+
+  EntryPtr load(const std::string& path);
+  bool isValid(const std::string& path, const EntryPtr& entry) const;
+  EntryPtr compress(const EntryPtr& entry) const;
+
+  void insert(const std::string& path, const EntryPtr& entry,
+	      std::time_t now);
+  void remove(ItemMap::iterator i);
+  void evict();
+
+  static ::int64_t entrySize(const EntryPtr& entry);
+  static FilePtr readFile(const std::string& path, ::int64_t size,
+			  std::time_t mtime);
+  static bool compressible(const std::string& contentType);
+};
+
+} // namespace server
+} // namespace http
+
+#endif // HTTP_STATIC_FILE_CACHE_HPP
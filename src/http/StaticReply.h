@@ -24,6 +24,7 @@
 namespace asio = boost::asio;
 
 #include "Reply.h"
+#include "StaticFileCache.h"
 
 namespace http {
 namespace server {
@@ -34,7 +35,9 @@ class Request;
 class StaticReply : public Reply
 {
 public:
-  StaticReply(Request& request, const Configuration& config);
+  StaticReply(Request& request, const Configuration& config,
+	      StaticFileCache& cache);
+  virtual ~StaticReply();
 
   virtual void reset(const Wt::EntryPoint *ep);
   virtual void writeDone(bool success);
@@ -48,8 +51,12 @@ protected:
   virtual ::int64_t contentLength();
 
   virtual bool nextContentBuffers(std::vector<asio::const_buffer>& result);
+  virtual bool nextContentFileRegion(FileRegion& result);
 
 private:
+  StaticFileCache& cache_;
+  StaticFileCache::FilePtr cached_;
+
   std::string path_;
   std::string extension_;
   std::ifstream stream_;
@@ -57,6 +64,13 @@ private:
 
   char buf_[64 * 1024];
 
+  // file descriptor and remaining region, when using sendfile()
+  int fd_;
+  ::int64_t fileOffset_, fileRemaining_;
+
+  bool startSendFile();
+  void closeFile();
+
   std::string computeModifiedDate() const;
   std::string computeETag() const;
   static std::string computeExpires();
@@ -27,6 +27,10 @@ namespace asio = boost::asio;
 
 #include "Connection.h"
 
+#if defined(HAVE_SENDFILE) && BOOST_VERSION >= 104700
+#define WTHTTP_WITH_SENDFILE
+#endif
+
 namespace http {
 namespace server {
 
@@ -46,17 +50,33 @@ public:
 
   virtual const char *urlScheme() { return "http"; }
 
+  virtual bool sendFileSupported();
+
 protected:
   virtual void startAsyncReadRequest(Buffer& buffer, int timeout);
   virtual void startAsyncReadBody(ReplyPtr reply, Buffer& buffer, int timeout);
   virtual void startAsyncWriteResponse
       (ReplyPtr reply, const std::vector<asio::const_buffer>& buffers,
        int timeout);
+#ifdef WTHTTP_WITH_SENDFILE
+  virtual void startAsyncSendFile(ReplyPtr reply,
+				  const Reply::FileRegion& region,
+				  int timeout);
+#endif // WTHTTP_WITH_SENDFILE
 
   virtual void stop();
 
   /// Socket for the connection.
   asio::ip::tcp::socket socket_;
+
+private:
+#ifdef WTHTTP_WITH_SENDFILE
+  /// File region that is being written using sendfile()
+  Reply::FileRegion sendFileRegion_;
+  std::size_t sendFileTransferred_;
+
+  void handleSendFile(ReplyPtr reply, const asio_error_code& e);
+#endif // WTHTTP_WITH_SENDFILE
 };
 
 typedef boost::shared_ptr<TcpConnection> TcpConnectionPtr;
@@ -61,6 +61,17 @@ public:
   bool empty() const;
   void clear();
 
+  /*
+   * The implementations of the scan for characters that need escaping.
+   * By default, the fastest one that the CPU supports is used. Other
+   * ones can be selected for testing.
+   */
+  enum Scanner { DefaultScanner = -1, ScalarScanner = 0,
+		 SSE2Scanner = 1, AVX2Scanner = 2 };
+
+  static bool scannerSupported(Scanner scanner);
+  static void setScanner(Scanner scanner);
+
 private:
   WStringStream own_stream_;
   WStringStream& stream_;
@@ -73,8 +84,14 @@ private:
   std::string special_;
   const char *c_special_;
 
+  /*
+   * For every byte value: 0 if it is copied verbatim, or else 1 + the
+   * index in mixed_ of its replacement.
+   */
+  unsigned char replacement_[256];
+
   void mixRules();
-  void put(const char *s, const EscapeOStream& rules);
+  void put(const char *s, std::size_t len, const EscapeOStream& rules);
 
   void sAppend(char c);
   void sAppend(const char *s, int length);
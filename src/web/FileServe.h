@@ -9,6 +9,9 @@
 
 #include <string>
 #include <map>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
 
 namespace Wt {
 
@@ -27,6 +30,13 @@ class WStringStream;
  *  _$_$ifnot_condition_$_;
  *     ...
  *  _$_$endif_$_;
+ *
+ * A template is parsed only once, and rendered only once for each
+ * combination of conditions, into a list of literal text and
+ * variables that is shared (process-wide) by all FileServe objects
+ * streaming it. Streaming then only splices in the variable values.
+ * A template is identified by its contents pointer, which must
+ * therefore remain valid for the lifetime of the application.
  */
 class FileServe
 {
@@ -42,11 +52,21 @@ public:
   void stream(WStringStream& out);
   void streamUntil(WStringStream& out, const std::string& until);
 
+  struct Segment {
+    bool isVar;
+    std::string text; // literal text or variable name
+  };
+
+  typedef std::vector<Segment> Rendering;
+
 private:
   const char *template_;
-  int currentPos_;
+  boost::shared_ptr<const Rendering> rendering_;
+  std::size_t currentSegment_;
   std::map<std::string, std::string> vars_;
   std::map<std::string, bool> conditions_;
+
+  void render();
 };
 
 }
@@ -0,0 +1,69 @@
+// This may look like C code, but it's really -*- C++ -*-
+/*
+ * Copyright (C) 2016 Emweb bvba, Herent, Belgium.
+ *
+ * See the LICENSE file for terms of use.
+ */
+#ifndef PUSH_RATE_LIMITER_H_
+#define PUSH_RATE_LIMITER_H_
+
+#include <Wt/WApplication>
+
+#include "web/TimeUtil.h"
+
+namespace Wt {
+
+/*
+ * Keeps the time between server-initiated updates (pushes) of a session
+ * to at least the configured interval, so that the changes made in
+ * between are coalesced in a single update. For a client that cannot
+ * keep up, the interval is increased (see written()).
+ *
+ * Times are passed as arguments, rather than read from the clock.
+ */
+class WT_API PushRateLimiter
+{
+public:
+  // the maximum interval between pushed updates for a slow client
+  static const int MaxBackoff = 5000;
+
+  PushRateLimiter();
+
+  void setInterval(int milliSeconds);
+  int interval() const { return interval_; }
+
+  // the current increased interval, or 0
+  int backoff() const { return backoff_; }
+
+  // an update was triggered
+  void triggered();
+
+  // an update is needed: the latency of the next push starts now
+  void requested(const Time& now);
+
+  // the pending changes were sent in the response to a client event
+  void responded();
+
+  // how long (in ms) a push should still be delayed
+  int delay(const Time& now) const;
+
+  // an update was pushed
+  void pushed(const Time& now);
+
+  // the client received a pushed update, which took writeTime ms
+  void written(int writeTime);
+
+  WApplication::UpdateStatistics statistics() const;
+
+private:
+  int interval_, backoff_;
+  bool requested_;
+  long triggered_, pushed_;
+  double latencyTotal_;
+  int latencyMax_;
+  Time lastPush_, requestTime_;
+};
+
+}
+
+#endif // PUSH_RATE_LIMITER_H_
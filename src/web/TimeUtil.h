@@ -28,6 +28,9 @@ public:
 
   int operator- (const Time& other) const; // milliseconds
 
+  bool operator< (const Time& other) const;
+  bool operator== (const Time& other) const;
+
 private:
   // Pointer to avoid inclusion of windows header files in wt
   class TimeImpl *t_;
@@ -17,6 +17,7 @@
 #include <Wt/WSocketNotifier>
 
 #include "SocketNotifier.h"
+#include "TimeUtil.h"
 
 #if defined(WT_THREADED) && !defined(WT_TARGET_JAVA)
 #include <boost/thread.hpp>
@@ -132,6 +133,7 @@ public:
 
   std::vector<std::string> sessions();
   bool expireSessions();
+  void expireChanged(WebSession *session);
   void start();
   void shutdown();
 
@@ -157,6 +159,7 @@ public:
 private:
   Configuration& conf_;
   std::string singleSessionId_;
+  bool singleSession_;
   bool autoExpire_;
   int plainHtmlSessions_, ajaxSessions_;
   volatile int zombieSessions_;
@@ -169,11 +172,46 @@ private:
   std::set<std::string> uploadProgressUrls_;
 
   typedef std::map<std::string, boost::shared_ptr<WebSession> > SessionMap;
-  SessionMap sessions_;
 
+  /*
+   * Session ids, ordered by the time at which they may expire. A
+   * session is rechecked when its time has come: if it has been
+   * active meanwhile it is queued again, so that expireSessions()
+   * only considers sessions that are due. Entries of removed sessions
+   * or for an outdated expire time are skipped.
+   */
+  typedef std::multimap<Time, std::string> ExpireQueue;
+
+  /*
+   * The sessions are distributed over a number of shards, based on a
+   * hash of the session id, each with its own lock. Every request
+   * looks up its session, and this way concurrent requests for
+   * different sessions rarely contend for the same lock.
+   */
+  static const int SESSION_SHARDS = 16;
+
+  struct SessionShard {
 #ifdef WT_THREADED
-  // mutex to protect access to the sessions map and plain/ajax session
-  // counts
+    boost::recursive_mutex mutex;
+#endif // WT_THREADED
+    SessionMap sessions;
+    ExpireQueue expireQueue;
+  };
+
+  SessionShard shards_[SESSION_SHARDS];
+
+  SessionShard& shard(const std::string& sessionId);
+
+  // assumes that you did grab the shard's mutex
+  void queueExpire(SessionShard& shard, WebSession *session,
+		   const Time& expire);
+  // assumes that you did grab the shard's mutex
+  void sessionRemoved(WebSession *session);
+
+#ifdef WT_THREADED
+  // mutex to protect access to the plain/ajax session counts and the
+  // single session id. It may be taken while holding a shard's mutex,
+  // but not the other way around.
   boost::recursive_mutex mutex_;
 
   SocketNotifier socketNotifier_;
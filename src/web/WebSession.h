@@ -23,6 +23,7 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/enable_shared_from_this.hpp>
 
+#include "PushRateLimiter.h"
 #include "TimeUtil.h"
 #include "WebRenderer.h"
 #include "WebRequest.h"
@@ -108,6 +109,12 @@ public:
   void resumeRendering();
   void setTriggerUpdate(bool needTrigger);
 
+  void setPushInterval(int milliSeconds)
+  { pushLimiter_.setInterval(milliSeconds); }
+  int pushInterval() const { return pushLimiter_.interval(); }
+  WApplication::UpdateStatistics pushStatistics() const
+  { return pushLimiter_.statistics(); }
+
   void expire();
   bool unlockRecursiveEventLoop();
 
@@ -273,6 +280,7 @@ private:
 			       WebWriteEvent event);
   static void webSocketReady(boost::weak_ptr<WebSession> session,
 			     WebWriteEvent event);
+  static void pushTimeout(boost::weak_ptr<WebSession> session);
 #endif
 
   void checkTimers();
@@ -314,6 +322,9 @@ private:
 
 #ifndef WT_TARGET_JAVA
   Time             expire_;
+  // the expire time under which the WebController has queued this session,
+  // protected by the WebController mutex
+  Time             expireQueued_;
 #endif
 
 #ifdef WT_BOOST_THREADS
@@ -327,6 +338,13 @@ private:
 #endif
   bool             updatesPending_, triggerUpdate_;
 
+  /* Rate limiting of server push */
+  PushRateLimiter  pushLimiter_;
+  bool             pushScheduled_, pushWriting_;
+#ifndef WT_TARGET_JAVA
+  Time             pushWriteTime_;
+#endif
+
   WEnvironment  embeddedEnv_;
   WEnvironment *env_;
   WApplication *app_;
@@ -381,6 +399,7 @@ private:
   friend class WebSocketMessage;
   friend class WebRenderer;
   friend class WebSocketSupport;
+  friend class WebController;
 };
 
 struct WEvent::Impl {